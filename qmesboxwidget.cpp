@@ -8,12 +8,32 @@
 #include <QScreen>
 #include <QMutexLocker>
 #include <QCloseEvent>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QPainter>
+#include <QListView>
+#include <QStringListModel>
+#include <QStyle>
+#include <QtConcurrent/QtConcurrentRun>
+#include <utility>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 //==========QMesBoxWidget============//
 
 
 QMesBoxWidget* QMesBoxWidget::mP_instance = nullptr; //初始化 静态实例
 QMutex QMesBoxWidget::m_mutex;                       //锁
+int QMesBoxWidget::m_imageCacheSize = 4096;          //图片缓存上限 默认4MB
+quint32 QMesBoxWidget::m_idleTrimTime = 60;          //空闲释放时间 默认60s
+quint32 QMesBoxWidget::m_trimCount = 0;              //释放次数
+quint32 QMesBoxWidget::m_rebuildCount = 0;           //重建次数
+QHash<QString,MesBoxProfile> QMesBoxWidget::m_profiles = {   //内置通知配置
+    {QStringLiteral("info"),  {LightTheme,  1, 1, 3, QEasingCurve::OutCubic}},
+    {QStringLiteral("warn"),  {ClassicTheme,1, 1, 5, QEasingCurve::OutCubic}},
+    {QStringLiteral("error"), {DarkTheme,   1, 1, 8, QEasingCurve::OutCubic}},
+};
 /**
  * @brief QMesBoxWidget 构造函数
  * @param text  消息 message
@@ -24,9 +44,11 @@ QMutex QMesBoxWidget::m_mutex;                       //锁
 QMesBoxWidget::QMesBoxWidget():
     QWidget(nullptr)
 {
+    m_imageCache.setMaxCost(m_imageCacheSize);
     initUI();
     initAnimation();
     initTimer();
+    startIdleTimer();                            // 创建后未显示也参与空闲释放
 }
 /**
  * @brief QMesBoxWidget::closeEvent
@@ -35,9 +57,23 @@ QMesBoxWidget::QMesBoxWidget():
  */
 void QMesBoxWidget::closeEvent(QCloseEvent *event){
     hideTimer->stop();
+    startIdleTimer();                            // 空闲计时，超时释放资源
     event->accept();  // 接受关闭事件
 }
 
+/**
+ * @brief QMesBoxWidget::startIdleTimer
+ * 提示框隐藏后开始空闲计时，已释放或不释放时跳过
+ * Starts the idle countdown once the message box is hidden, skipped if already trimmed or trimming is disabled
+ */
+void QMesBoxWidget::startIdleTimer(){
+    if(m_trimmed || 0 == m_idleTrimTime){
+        idleTimer->stop();
+        return;
+    }
+    idleTimer->start(m_idleTrimTime*1000);
+}
+
 /**
  * @brief QMesBoxWidget::initUI
  * 初始化UI，跟随屏幕设置窗口大小
@@ -121,12 +157,48 @@ void QMesBoxWidget::initUI(){
     // 添加标题区域到 frame 布局
     frameLayout->addWidget(titleArea);
 
+    // 内容区域 图标 + 文本
+    contentArea = new QWidget(frame);
+    contentArea->setObjectName("contentArea");
+    contentLayout = new QHBoxLayout(contentArea);
+    contentLayout->setSpacing(0);
+    contentLayout->setContentsMargins(0, 0, 0, 0);
+
+    // 图标标签 无图标时隐藏，左侧留出15px边距
+    m_iconSide = qBound(24, this->height() / 4, 64);
+    iconLabel = new QLabel(contentArea);
+    iconLabel->setObjectName("iconLabel");
+    iconLabel->setFixedSize(m_iconSide + 15, m_iconSide);
+    iconLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    iconLabel->hide();
+
     // 内容标签
-    contentLabel = new QLabel(m_content, frame);
+    contentLabel = new QLabel(m_content, contentArea);
     contentLabel->setObjectName("contentLabel");
     contentLabel->setAlignment(Qt::AlignCenter);
     contentLabel->setWordWrap(true);
-    frameLayout->addWidget(contentLabel);
+
+    contentLayout->addWidget(iconLabel);
+    contentLayout->addWidget(contentLabel, 1);
+    frameLayout->addWidget(contentArea);
+
+    // 批量消息列表 统一行高，只布局、绘制可见行
+    batchList = new QListView(frame);
+    batchList->setObjectName("batchList");
+    batchList->setUniformItemSizes(true);
+    batchList->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    batchList->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    batchList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    batchList->setSelectionMode(QAbstractItemView::NoSelection);
+    batchList->setFocusPolicy(Qt::NoFocus);
+    batchList->setTextElideMode(Qt::ElideRight);
+    batchModel = new QStringListModel(batchList);
+    batchList->setModel(batchModel);
+    batchList->hide();
+    frameLayout->addWidget(batchList);
+
+    // 样式随主题变化的控件，切换主题时只重新 polish 这些控件
+    m_themedWidgets = {frame, titleArea, titleLabel, countLabel, contentLabel, batchList};
 
     // 添加 frame 到主布局
     mainLayout->addWidget(frame);
@@ -145,42 +217,56 @@ void QMesBoxWidget::initUI(){
 }
 
 /**
-  * @brief QMesBoxWidget::styleSheet
+  * @brief QMesBoxWidget::themeName
   * @param themeType 主题类型
-  * @param widget    需要设置窗口
-  * 样式表设置   Style sheet Settings
+  * @return          主题名称，对应样式表中的 theme 属性选择器
   */
-void QMesBoxWidget::styleSheet(Theme themeType, QWidget *widget){
-    if(!widget){
-        return;
-    }
+const char *QMesBoxWidget::themeName(Theme themeType){
     switch (themeType) {
+    case LightTheme:
+        return "light";
+    case DarkTheme:
+        return "dark";
     case ClassicTheme:
-        // 设置样式
-        widget->setStyleSheet(R"(
+    default:
+        return "classic";
+    }
+}
+
+/**
+  * @brief QMesBoxWidget::themeStyleSheet
+  * @return 全部主题合并的样式表，按窗口 theme 属性区分主题，只需解析一次
+  * 样式表数据   Combined style sheet of all themes, selected by the theme property so it is parsed only once
+  */
+const QString &QMesBoxWidget::themeStyleSheet(){
+    static const QString style = R"(
     #frame {
-        background-color: rgb(70, 70, 70);  /* 深灰色背景 */
         border: none;
         border-radius: 12px;
     }
     #titleArea {
-        background-color: rgb(90, 90, 90);  /* 深灰色稍微浅一点 */
         border-radius: 8px;
     }
     #titleLabel {
         background-color: transparent;
-        color: rgb(255, 255, 255);  /* 白色文字 */
         font-size: 12px;
     }
+    #contentArea, #iconLabel {
+        background-color: transparent;
+    }
     #contentLabel {
         background-color: transparent;
         padding: 10px 20px;
-        color: rgb(200, 200, 200);  /* 浅灰色文字 */
+        font-size: 12px;
+    }
+    #batchList {
+        background-color: transparent;
+        border: none;
+        padding: 5px 10px;
         font-size: 12px;
     }
     #countLabel {
         background-color: transparent;
-        color: rgb(100, 150, 255);  /* 浅蓝色文字 */
     }
     #btnClose {
         background: transparent;
@@ -195,128 +281,141 @@ void QMesBoxWidget::styleSheet(Theme themeType, QWidget *widget){
     #btnClose:pressed {
         background-color: rgb(220, 50, 50);  /* 按下时的红色 */
     }
-)");
-        break;
-    case LightTheme:
 
-        widget->setStyleSheet(R"(
-    #frame {
+    /* 经典主题 */
+    QMesBoxWidget[theme="classic"] #frame {
+        background-color: rgb(70, 70, 70);  /* 深灰色背景 */
+    }
+    QMesBoxWidget[theme="classic"] #titleArea {
+        background-color: rgb(90, 90, 90);  /* 深灰色稍微浅一点 */
+    }
+    QMesBoxWidget[theme="classic"] #titleLabel {
+        color: rgb(255, 255, 255);  /* 白色文字 */
+    }
+    QMesBoxWidget[theme="classic"] #contentLabel, QMesBoxWidget[theme="classic"] #batchList {
+        color: rgb(200, 200, 200);  /* 浅灰色文字 */
+    }
+    QMesBoxWidget[theme="classic"] #countLabel {
+        color: rgb(100, 150, 255);  /* 浅蓝色文字 */
+    }
+
+    /* 浅色主题 */
+    QMesBoxWidget[theme="light"] #frame {
         background-color: rgb(255, 255, 255);  /* 白色背景 */
-        border: none;
-        border-radius: 12px;
     }
-    #titleArea {
+    QMesBoxWidget[theme="light"] #titleArea {
         background-color: rgb(240, 240, 240);  /* 浅灰色 */
-        border-radius: 8px;
     }
-    #titleLabel {
-        background-color: transparent;
+    QMesBoxWidget[theme="light"] #titleLabel {
         color: rgb(0, 0, 0);  /* 黑色文字 */
-        font-size: 12px;
     }
-    #contentLabel {
-        background-color: transparent;
-        padding: 10px 20px;
+    QMesBoxWidget[theme="light"] #contentLabel, QMesBoxWidget[theme="light"] #batchList {
         color: rgb(80, 80, 80);  /* 深灰色文字 */
-        font-size: 12px;
     }
-    #countLabel {
-        background-color: transparent;
+    QMesBoxWidget[theme="light"] #countLabel {
         color: rgb(0, 120, 255);  /* 蓝色文字 */
     }
-    #btnClose {
-        background: transparent;
-        border: none;
-        border-radius: 10px;
-        padding: 5px;
-    }
-    #btnClose:hover {
-        background-color: rgb(255, 80, 80);  /* 橙红色背景 */
-        color: white;
-    }
-    #btnClose:pressed {
-        background-color: rgb(220, 50, 50);  /* 按下时的红色 */
-    }
-)");
 
-        break;
-    case DarkTheme:
-        widget->setStyleSheet(R"(
-    #frame {
+    /* 深色主题 */
+    QMesBoxWidget[theme="dark"] #frame {
         background-color: rgb(30, 30, 30);  /* 深灰色背景 */
-        border: none;
-        border-radius: 12px;
     }
-    #titleArea {
+    QMesBoxWidget[theme="dark"] #titleArea {
         background-color: rgb(50, 50, 50);  /* 稍浅的深灰色 */
-        border-radius: 8px;
     }
-    #titleLabel {
-        background-color: transparent;
+    QMesBoxWidget[theme="dark"] #titleLabel {
         color: rgb(255, 255, 255);  /* 白色文字 */
-        font-size: 12px;
     }
-    #contentLabel {
-        background-color: transparent;
-        padding: 10px 20px;
+    QMesBoxWidget[theme="dark"] #contentLabel, QMesBoxWidget[theme="dark"] #batchList {
         color: rgb(200, 200, 200);  /* 浅灰色文字 */
-        font-size: 12px;
     }
-    #countLabel {
-        background-color: transparent;
+    QMesBoxWidget[theme="dark"] #countLabel {
         color: rgb(100, 150, 255);  /* 浅蓝色文字 */
     }
-    #btnClose {
-        background: transparent;
-        border: none;
-        border-radius: 10px;
-        padding: 5px;
-    }
-    #btnClose:hover {
-        background-color: rgb(255, 80, 80);  /* 橙红色背景 */
-        color: white;
-    }
-    #btnClose:pressed {
-        background-color: rgb(220, 50, 50);  /* 按下时的红色 */
+)";
+    return style;
+}
+
+/**
+  * @brief QMesBoxWidget::applyTheme
+  * @param themeType 主题类型
+  * 主题切换：样式表只在首次设置时解析，之后切换主题只修改 theme 属性并重新 polish 受主题影响的控件
+  * Theme switching: the style sheet is parsed only when first set, later switches only change the theme property
+  * and re-polish the widgets whose style depends on the theme
+  */
+void QMesBoxWidget::applyTheme(Theme themeType){
+    if(m_appliedTheme == themeType){
+        return;
     }
-)");
-        break;
+    this->setProperty("theme", QString::fromLatin1(themeName(themeType)));
+    if(m_appliedTheme < 0){
+        this->setStyleSheet(themeStyleSheet());
+    }else{
+        // 属性选择器不会自动刷新，只重新 polish 带主题规则的控件，其余控件（列表视口、滚动条等）不受影响
+        for(QWidget* widget : std::as_const(m_themedWidgets)){
+            widget->style()->unpolish(widget);
+            widget->style()->polish(widget);
+            widget->update();
+        }
     }
+    m_appliedTheme = themeType;
 }
 
 /**
  * @brief QMesBoxWidget::initAnimation
- * 初始化动画，将所需动画添加到动画组中
- * Initializes the animation, adding the desired animation to the animation group
+ * 初始化动画：预构建默认时间动画与全部已注册配置的动画，并将默认动画设为当前动画
+ * Initializes the animation: prebuilds the default timed animation and the animations of all registered profiles,
+ * and makes the default animation the current one
  */
 void QMesBoxWidget::initAnimation(){
-    quint32 inTime = m_AnimationInTime*1000;
-    quint32 outTime = m_AnimationOutTime*1000;
+    for(auto it = m_profiles.constBegin(); it != m_profiles.constEnd(); ++it){
+        buildProfileAnimation(it.key(),it.value());
+    }
+    useDefaultAnimation();
+}
+
+/**
+ * @brief QMesBoxWidget::buildAnimation
+ * 构建动画，将所需动画添加到动画组中，起止位置与时长在构建时确定
+ * Builds the animation, adding the desired animation to the animation group,
+ * start/end positions and durations are fixed at build time
+ * @param AniInTime  动画进入时间
+ * @param AniOutTime 动画退出时间
+ * @param easing     动画曲线
+ * @param groupIn    输出 进入动画组
+ * @param groupOut   输出 退出动画组
+ */
+void QMesBoxWidget::buildAnimation(quint32 AniInTime, quint32 AniOutTime, const QEasingCurve &easing,
+                                   QParallelAnimationGroup *&groupIn, QParallelAnimationGroup *&groupOut){
+    quint32 inTime = AniInTime*1000;
+    quint32 outTime = AniOutTime*1000;
     mode = AnimationMode::AllAnimation;  // 设置启用透明度和位置动画
-    m_aniGroupIn = new QParallelAnimationGroup(this);
-    m_aniGroupOut = new QParallelAnimationGroup(this);
+    groupIn = new QParallelAnimationGroup(this);
+    groupOut = new QParallelAnimationGroup(this);
     //透明度动画
-    m_opacityIn = new QPropertyAnimation(this,"windowOpacity");
-    m_opacityOut = new QPropertyAnimation(this,"windowOpacity");
+    QPropertyAnimation* opacityIn = new QPropertyAnimation(this,"windowOpacity");
+    QPropertyAnimation* opacityOut = new QPropertyAnimation(this,"windowOpacity");
     //判断是否设置了透明度动画
     if(mode&AnimationMode::OpacityAnimation){
-        m_opacityIn->setDuration(inTime);
-        m_opacityIn->setStartValue(0);
-        m_opacityOut->setDuration(outTime);
-        m_opacityOut->setStartValue(0);
+        opacityIn->setDuration(inTime);
+        opacityIn->setStartValue(0);
+        opacityOut->setDuration(outTime);
+        opacityOut->setStartValue(0);
     }else{
-        m_opacityIn->setDuration(0);
-        m_opacityIn->setStartValue(1);
-        m_opacityOut->setDuration(0);
-        m_opacityOut->setStartValue(1);
-    }
-    m_opacityIn->setEndValue(1);
-    m_opacityOut->setEndValue(1);
-    m_aniGroupIn->addAnimation(m_opacityIn);
-    m_aniGroupOut->addAnimation(m_opacityOut);
+        opacityIn->setDuration(0);
+        opacityIn->setStartValue(1);
+        opacityOut->setDuration(0);
+        opacityOut->setStartValue(1);
+    }
+    opacityIn->setEndValue(1);
+    opacityOut->setEndValue(1);
+    opacityIn->setEasingCurve(easing);
+    opacityOut->setEasingCurve(easing);
+    groupIn->addAnimation(opacityIn);
+    groupOut->addAnimation(opacityOut);
     //位置动画
-    m_positionIn = new QPropertyAnimation(this,"pos");
-    m_positionOut = new QPropertyAnimation(this,"pos");
+    QPropertyAnimation* positionIn = new QPropertyAnimation(this,"pos");
+    QPropertyAnimation* positionOut = new QPropertyAnimation(this,"pos");
     QScreen* screen = QGuiApplication::primaryScreen();
     if(screen){
         const QRect desk_rect = screen->availableGeometry();
@@ -326,23 +425,157 @@ void QMesBoxWidget::initAnimation(){
                               desk_rect.height() - this->height() };
         //判断是否设置了此模式的动画
         if (mode&AnimationMode::PosAnimation){
-            m_positionIn->setDuration(inTime);
-            m_positionIn->setStartValue(hide_pos);
-            m_positionOut->setDuration(outTime);
-            m_positionOut->setStartValue(hide_pos);
+            positionIn->setDuration(inTime);
+            positionIn->setStartValue(hide_pos);
+            positionOut->setDuration(outTime);
+            positionOut->setStartValue(hide_pos);
         }
         else{
-            m_positionIn->setDuration(0);
-            m_positionIn->setStartValue(position);
-            m_positionOut->setDuration(0);
-            m_positionOut->setStartValue(position);
+            positionIn->setDuration(0);
+            positionIn->setStartValue(position);
+            positionOut->setDuration(0);
+            positionOut->setStartValue(position);
+        }
+        positionIn->setEndValue(position);
+        positionOut->setEndValue(position);
+    }
+    positionIn->setEasingCurve(easing);
+    positionOut->setEasingCurve(easing);
+    groupIn->addAnimation(positionIn);
+    groupOut->addAnimation(positionOut);
+    //动画结束信号只在创建时绑定一次
+    connect(groupIn,&QAbstractAnimation::finished,this,[this](){
+        hideTimer->start();
+    });
+    connect(groupOut,&QAbstractAnimation::finished,this,[this]{
+        this->close();
+    });
+}
+
+/**
+ * @brief QMesBoxWidget::useAnimation
+ * 设置当前使用的动画组与保持时间
+ * Sets the current animation groups and hold time
+ */
+void QMesBoxWidget::useAnimation(QParallelAnimationGroup *groupIn, QParallelAnimationGroup *groupOut, quint32 KeepTime){
+    m_curGroupIn = groupIn;
+    m_curGroupOut = groupOut;
+    m_curKeepTime = KeepTime;
+}
+
+/**
+ * @brief QMesBoxWidget::timeAnimation
+ * 线性动画组按进入、退出时间就地调整时长，只在首次使用时构建，不随时间组合增加动画对象
+ * Retunes the durations of the linear animation groups in place, built only on first use,
+ * so new time combinations do not add animation objects
+ * @param plan       动画组
+ * @param AniInTime  动画进入时间
+ * @param AniOutTime 动画退出时间
+ */
+void QMesBoxWidget::timeAnimation(TimedAnimation &plan, quint32 AniInTime, quint32 AniOutTime){
+    if(nullptr == plan.groupIn){
+        buildAnimation(AniInTime,AniOutTime,QEasingCurve::Linear,plan.groupIn,plan.groupOut);
+    }else if(plan.aniInTime != AniInTime || plan.aniOutTime != AniOutTime){
+        retimeGroup(plan.groupIn,AniInTime*1000);
+        retimeGroup(plan.groupOut,AniOutTime*1000);
+    }
+    plan.aniInTime = AniInTime;
+    plan.aniOutTime = AniOutTime;
+}
+
+/**
+ * @brief QMesBoxWidget::retimeGroup
+ * 设置动画组内各动画时长，未启用的动画类型保持 0
+ * Sets the duration of each animation in the group, disabled animation types stay at 0
+ */
+void QMesBoxWidget::retimeGroup(QParallelAnimationGroup *group, quint32 duration){
+    for(int i = 0; i < group->animationCount(); ++i){
+        QPropertyAnimation* animation = qobject_cast<QPropertyAnimation*>(group->animationAt(i));
+        if(!animation){
+            continue;
         }
-        m_positionIn->setEndValue(position);
-        m_positionOut->setEndValue(position);
+        const bool enabled = animation->propertyName() == "pos" ? (mode&AnimationMode::PosAnimation)
+                                                                : (mode&AnimationMode::OpacityAnimation);
+        animation->setDuration(enabled ? int(duration) : 0);
+    }
+}
+
+/**
+ * @brief QMesBoxWidget::useDefaultAnimation
+ * 使用 setMesBox 设置的时间对应的动画
+ * Uses the animation for the times set by setMesBox
+ */
+void QMesBoxWidget::useDefaultAnimation(){
+    timeAnimation(m_defaultAnimation,m_AnimationInTime,m_AnimationOutTime);
+    useAnimation(m_defaultAnimation.groupIn,m_defaultAnimation.groupOut,m_AnimationDispalyTime);
+}
+
+/**
+ * @brief QMesBoxWidget::buildProfileAnimation
+ * 预构建配置对应的动画组，已构建时跳过
+ * Prebuilds the animation groups of the profile, skipped if already built
+ */
+void QMesBoxWidget::buildProfileAnimation(const QString &profileId, const MesBoxProfile &profile){
+    ProfileAnimation &plan = m_profileAnimations[profileId];
+    if(nullptr == plan.groupIn){
+        buildAnimation(profile.aniInTime,profile.aniOutTime,profile.easing,plan.groupIn,plan.groupOut);
+    }
+}
+
+/**
+ * @brief QMesBoxWidget::useProfile
+ * 使用配置对应的预构建动画与主题，注册时已构建，此处仅查表
+ * Uses the prebuilt animation and theme of the profile, built at registration so this is only a lookup
+ */
+void QMesBoxWidget::useProfile(const QString &profileId, const MesBoxProfile &profile){
+    buildProfileAnimation(profileId,profile);           // 已构建时直接返回
+    const ProfileAnimation &plan = m_profileAnimations[profileId];
+    useAnimation(plan.groupIn,plan.groupOut,profile.keepTime);
+    applyTheme(profile.theme);
+}
+
+/**
+ * @brief QMesBoxWidget::prepareDefault
+ * 通用调用使用 setMesBox 设置的主题与动画
+ * Generic calls use the theme and animation set by setMesBox
+ */
+void QMesBoxWidget::prepareDefault(){
+    useDefaultAnimation();
+    applyTheme(m_theme);
+}
+
+/**
+ * @brief QMesBoxWidget::findProfile
+ * 按名称查找通知配置，未注册时输出提示并返回空
+ * Finds a notification profile by id, logs and returns nullptr if it is not registered
+ */
+const MesBoxProfile *QMesBoxWidget::findProfile(const QString &profileId){
+    auto it = m_profiles.constFind(profileId);
+    if(it == m_profiles.constEnd()){
+        qDebug()<<"Unknown message box profile:"<<profileId;
+        return nullptr;
     }
-    m_aniGroupIn->addAnimation(m_positionIn);
-    m_aniGroupOut->addAnimation(m_positionOut);
+    return &it.value();
+}
 
+/**
+ * @brief QMesBoxWidget::dropProfileAnimation
+ * 释放配置对应的动画组，正在使用时先关闭提示框
+ * Releases the animation groups of the profile, closing the message box first if they are in use
+ */
+void QMesBoxWidget::dropProfileAnimation(const QString &profileId){
+    auto it = m_profileAnimations.find(profileId);
+    if(it == m_profileAnimations.end()){
+        return;
+    }
+    if(m_curGroupIn == it->groupIn){
+        stopAnimation();
+        this->close();
+        useDefaultAnimation();
+    }
+    delete it->groupIn;
+    delete it->groupOut;
+    m_profileAnimations.erase(it);
 }
 
 /**
@@ -363,6 +596,144 @@ void QMesBoxWidget::initTimer(){
             animationOut();
         }
     });
+    idleTimer = new QTimer(this);
+    idleTimer->setSingleShot(true);
+    connect(idleTimer,&QTimer::timeout,this,&QMesBoxWidget::releaseResources);
+}
+
+/**
+ * @brief decodeImage
+ * 线程池中执行：读取并缩放图片到目标像素尺寸，只解码所需尺寸
+ * Runs on the thread pool: reads and scales the image to the target pixel size, decoding only the needed size
+ */
+static QImage decodeImage(const QString &image, const QSize &size){
+    QImageReader reader(image);
+    reader.setAutoTransform(true);
+    const QSize sourceSize = reader.size();
+    if(sourceSize.isValid()){
+        reader.setScaledSize(sourceSize.scaled(size, Qt::KeepAspectRatio));
+    }
+    QImage result = reader.read();
+    if(result.isNull()){
+        qDebug()<<"Unable to read image:"<<image<<reader.errorString();
+        return result;
+    }
+    if(result.width() > size.width() || result.height() > size.height()){
+        result = result.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    result.convertTo(QImage::Format_ARGB32_Premultiplied);  // 预乘格式，GUI线程转换 QPixmap 无需再转格式
+    return result;
+}
+
+/**
+ * @brief QMesBoxWidget::placeholder
+ * 图标占位图，解码完成前显示
+ * Icon placeholder shown until decoding finishes
+ */
+QPixmap QMesBoxWidget::placeholder(){
+    const qreal dpr = this->devicePixelRatioF();
+    if(m_placeholder.isNull() || !qFuzzyCompare(m_placeholder.devicePixelRatio(), dpr)){
+        m_placeholder = QPixmap(QSize(m_iconSide, m_iconSide) * dpr);
+        m_placeholder.setDevicePixelRatio(dpr);
+        m_placeholder.fill(Qt::transparent);
+        QPainter painter(&m_placeholder);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(128, 128, 128, 60));
+        painter.drawRoundedRect(QRectF(0, 0, m_iconSide, m_iconSide), 6, 6);
+    }
+    return m_placeholder;
+}
+
+/**
+ * @brief QMesBoxWidget::setImage
+ * 设置图标：命中缓存直接显示，否则显示占位图并在线程池中解码，同一图片同一尺寸只解码一次
+ * Sets the icon: shown directly on a cache hit, otherwise a placeholder is shown while the thread pool decodes it,
+ * the same image at the same size is only decoded once
+ * @param image 图片路径，为空时隐藏图标
+ */
+void QMesBoxWidget::setImage(const QString &image){
+    if(image.isEmpty()){
+        m_imageKey.clear();
+        iconLabel->clear();
+        iconLabel->hide();
+        return;
+    }
+    const qreal dpr = this->devicePixelRatioF();
+    const QSize size = QSize(m_iconSide, m_iconSide) * dpr;
+    // 拼接而非链式 arg，路径中的 %N（如 %20）不会被替换
+    const QString key = image + QLatin1Char('@') + QString::number(size.width())
+                        + QLatin1Char('x') + QString::number(size.height());
+    m_imageKey = key;
+    iconLabel->show();
+    if(const QPixmap *pixmap = m_imageCache.object(key)){
+        iconLabel->setPixmap(*pixmap);
+        return;
+    }
+    iconLabel->setPixmap(placeholder());
+    if(m_imageLoading.contains(key)){
+        return;
+    }
+    m_imageLoading.insert(key);
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    const quint32 trims = m_trimCount;
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, key, dpr, trims]{
+        watcher->deleteLater();
+        // 解码期间已空闲释放：丢弃结果，不重新填充已清空的缓存
+        if(trims != m_trimCount){
+            return;
+        }
+        m_imageLoading.remove(key);
+        const QImage result = watcher->result();
+        if(result.isNull()){
+            if(m_imageKey == key && iconLabel){
+                iconLabel->hide();
+            }
+            return;
+        }
+        QPixmap pixmap = QPixmap::fromImage(result);
+        pixmap.setDevicePixelRatio(dpr);
+        const int cost = qMax(1, int(result.sizeInBytes() / 1024));
+        m_imageCache.insert(key, new QPixmap(pixmap), cost);
+        if(m_imageKey == key && iconLabel){
+            iconLabel->setPixmap(pixmap);
+        }
+    });
+    watcher->setFuture(QtConcurrent::run([image, size]{
+        return decodeImage(image, size);
+    }));
+}
+
+/**
+ * @brief QMesBoxWidget::setBatch
+ * 设置批量消息，列表共享传入数据不逐条复制；为空时清空列表并恢复单条内容显示
+ * Sets the batch messages, the list shares the given data instead of copying each row;
+ * an empty list clears it and restores the single message content
+ * @param messages 消息列表
+ */
+void QMesBoxWidget::setBatch(const QStringList &messages){
+    const bool batch = !messages.isEmpty();
+    if(batch || batchModel->rowCount() > 0){
+        batchModel->setStringList(messages);
+    }
+    if(batch){
+        batchList->scrollToTop();
+    }
+    batchList->setVisible(batch);
+    contentArea->setVisible(!batch);
+}
+
+/**
+ * @brief QMesBoxWidget::showBatch
+ * 显示批量提示，标题附带消息数量
+ * Shows the batch message box, the title carries the message count
+ */
+void QMesBoxWidget::showBatch(const QString &title, const QStringList &messages){
+    setImage(QString());
+    setBatch(messages);
+    titleLabel->setText(QStringLiteral("%1 (%2)").arg(title, QString::number(messages.size())));
+    raise();
+    show();
 }
 
 /**
@@ -372,42 +743,94 @@ void QMesBoxWidget::initTimer(){
  */
 void QMesBoxWidget::stopAnimation()
 {
-    m_aniGroupIn->stop();
-    m_aniGroupOut->stop();
+    if(m_curGroupIn){
+        m_curGroupIn->stop();
+    }
+    if(m_curGroupOut){
+        m_curGroupOut->stop();
+    }
     hideTimer->stop();
+    idleTimer->stop();
 }
+
 /**
- * @brief QMesBoxWidget::checkTime
- * check 动画时间是否改变
- * Whether the animation time is changed
+ * @brief QMesBoxWidget::releaseResources
+ * 空闲释放资源：控件树、阴影缓冲、样式数据、动画对象以及窗口后备缓存，仅保留实例与定时器
+ * Release idle resources: widget subtree, shadow buffer, style data, animation objects and the window backing store,
+ * only the instance handle and timers are kept
  */
-bool QMesBoxWidget::checkTime()
+void QMesBoxWidget::releaseResources()
 {
-    if(m_AnimationInTime != m_temporaryAnimaIn || m_AnimationOutTime != m_temporaryAnimaOut || m_AnimationDispalyTime != m_temporaryAnimaDis){
-        m_AnimationInTime = m_temporaryAnimaIn;
-        m_AnimationOutTime = m_temporaryAnimaOut;
-        m_AnimationDispalyTime = m_temporaryAnimaDis;
-        return true;
+    if(m_trimmed || isVisible()){
+        return;
+    }
+    stopAnimation();
+    for(TimedAnimation *plan : {&m_defaultAnimation,&m_singleAnimation}){
+        delete plan->groupIn;                           // 子动画随动画组释放
+        delete plan->groupOut;
+        *plan = TimedAnimation();
+    }
+    for(const ProfileAnimation &plan : std::as_const(m_profileAnimations)){
+        delete plan.groupIn;
+        delete plan.groupOut;
     }
-    return false;
+    m_profileAnimations.clear();
+    useAnimation(nullptr,nullptr,m_AnimationDispalyTime);
+    delete mainLayout;
+    delete frame;                                       // 子控件与阴影效果随 frame 释放
+    mainLayout = frameLayout = nullptr;
+    frame = nullptr;
+    titleArea = nullptr;
+    titleLayout = nullptr;
+    titleLabel = countLabel = contentLabel = iconLabel = nullptr;
+    m_themedWidgets.clear();
+    contentArea = nullptr;
+    contentLayout = nullptr;
+    batchList = nullptr;                                // 批量模型随列表释放
+    batchModel = nullptr;
+    m_imageKey.clear();
+    m_imageCache.clear();                               // 已解码图片缓存
+    m_imageLoading.clear();                             // 进行中的解码结果完成后丢弃
+    m_placeholder = QPixmap();
+    btnClose = nullptr;
+    this->setStyleSheet(QString());
+    m_appliedTheme = -1;
+    this->destroy();                                    // 释放原生窗口及后备缓存，show 时自动重建
+#ifdef __GLIBC__
+    malloc_trim(0);                                     // 将释放的堆内存归还系统，否则常驻内存不会下降
+#endif
+    m_trimmed = true;
+    ++m_trimCount;
 }
 
+/**
+ * @brief QMesBoxWidget::rebuildResources
+ * 重建被释放的资源
+ * Rebuild the released resources
+ */
+void QMesBoxWidget::rebuildResources()
+{
+    if(!m_trimmed){
+        return;
+    }
+    initUI();
+    initAnimation();
+    m_trimmed = false;
+    ++m_rebuildCount;
+}
 /**
  * @brief QMesBoxWidget::animationIn
  * 动画进入，正向加载动画组，动画结束启动定时器
  * The animation enters, the animation group is loaded forward, and the timer is started when the animation ends
  */
 void QMesBoxWidget::animationIn(){
-    hideCount = m_AnimationDispalyTime;
+    hideCount = m_curKeepTime;
     QString text = QStringLiteral("Close:%1s").arg(hideCount);
     this->countLabel->setText(text);
     this->setWindowModality(Qt::WindowModal);
-    if(m_aniGroupIn && m_aniGroupIn->state() != QPropertyAnimation::Running){
-        m_aniGroupIn->setDirection(QAbstractAnimation::Forward);
-        m_aniGroupIn->start();
-        connect(m_aniGroupIn,&QPropertyAnimation::finished,this,[this](){
-            hideTimer->start();
-        });
+    if(m_curGroupIn && m_curGroupIn->state() != QPropertyAnimation::Running){
+        m_curGroupIn->setDirection(QAbstractAnimation::Forward);
+        m_curGroupIn->start();
     }
 }
 
@@ -418,13 +841,30 @@ void QMesBoxWidget::animationIn(){
  */
 void QMesBoxWidget::animationOut(){
     this->setWindowModality(Qt::WindowModal);
-    if( m_aniGroupOut && m_aniGroupOut->state() != QPropertyAnimation::Running){
-        m_aniGroupOut->setDirection(QAbstractAnimation::Backward);
-        m_aniGroupOut->start();
-        connect(m_aniGroupOut,&QPropertyAnimation::finished,this,[this]{
-            this->close();
-        });
+    if( m_curGroupOut && m_curGroupOut->state() != QPropertyAnimation::Running){
+        m_curGroupOut->setDirection(QAbstractAnimation::Backward);
+        m_curGroupOut->start();
+    }
+}
+
+/**
+ * @brief QMesBoxWidget::instance
+ * 获取静态实例，已存在时中断当前提示，资源已释放时重建
+ * Gets the static instance, interrupts the current prompt if it exists, and rebuilds released resources
+ */
+QMesBoxWidget *QMesBoxWidget::instance()
+{
+    if(nullptr == mP_instance){
+        QMutexLocker locker(&m_mutex);
+        if(nullptr == mP_instance){
+            mP_instance = new QMesBoxWidget();
+        }
+    }else{
+        mP_instance->rebuildResources();
+        mP_instance->stopAnimation();
+        mP_instance->hide();
     }
+    return mP_instance;
 }
 
 /**
@@ -432,7 +872,7 @@ void QMesBoxWidget::animationOut(){
  * 自定义show方法   Customize the show method
  */
 void QMesBoxWidget::show(){
-
+    idleTimer->stop();
     animationIn();
     QWidget::show();
 }
@@ -447,23 +887,16 @@ void QMesBoxWidget::show(){
  * @param KeepTime                    窗口保持时间     Window hold time
  */
 void QMesBoxWidget::MesBox(Theme themeType,const QString& title,const QString& text,quint32 AniInTime,quint32 AniOutTime,quint32 KeepTime){
-    if(nullptr == mP_instance){
-        QMutexLocker locker(&m_mutex);
-        if(nullptr == mP_instance){
-            mP_instance = new QMesBoxWidget();
-        }
-    }else{
-        mP_instance->stopAnimation();
-        mP_instance->hide();
-    }
-    if(nullptr == mP_instance){
+    if(nullptr == instance()){
         return;
     }
-    mP_instance->m_AnimationInTime = AniInTime;
-    mP_instance->m_AnimationOutTime = AniOutTime;
-    mP_instance->m_AnimationDispalyTime = KeepTime;
-    mP_instance->initAnimation();
-    mP_instance->styleSheet(themeType,mP_instance);
+    // 单次提示不修改 setMesBox 设置的时间，使用单独的动画组，时间变化时就地调整
+    TimedAnimation &plan = mP_instance->m_singleAnimation;
+    mP_instance->timeAnimation(plan,AniInTime,AniOutTime);
+    mP_instance->useAnimation(plan.groupIn,plan.groupOut,KeepTime);
+    mP_instance->applyTheme(themeType);
+    mP_instance->setImage(QString());
+    mP_instance->setBatch(QStringList());
     mP_instance->titleLabel->setText(title);
     mP_instance->contentLabel->setText(text);
     mP_instance->raise();
@@ -479,16 +912,7 @@ void QMesBoxWidget::MesBox(Theme themeType,const QString& title,const QString& t
  */
 void QMesBoxWidget::setMesBox(Theme themeType, quint32 AniInTime, quint32 AniOutTime, quint32 KeepTime)
 {
-    if(nullptr == mP_instance){
-        QMutexLocker locker(&m_mutex);
-        if(nullptr == mP_instance){
-            mP_instance = new QMesBoxWidget();
-        }
-    }else{
-        mP_instance->stopAnimation();
-        mP_instance->hide();
-    }
-    if(nullptr == mP_instance){
+    if(nullptr == instance()){
         return;
     }
 
@@ -496,10 +920,8 @@ void QMesBoxWidget::setMesBox(Theme themeType, quint32 AniInTime, quint32 AniOut
     mP_instance->m_AnimationInTime = AniInTime;
     mP_instance->m_AnimationOutTime = AniOutTime;
     mP_instance->m_AnimationDispalyTime = KeepTime;
-    mP_instance->m_temporaryAnimaIn = AniInTime;
-    mP_instance->m_temporaryAnimaOut = AniOutTime;
-    mP_instance->m_temporaryAnimaDis = KeepTime;
-    mP_instance->initAnimation();
+    mP_instance->useDefaultAnimation();
+    mP_instance->startIdleTimer();              // 仅设置未显示时同样空闲释放
 }
 
 /**
@@ -509,25 +931,142 @@ void QMesBoxWidget::setMesBox(Theme themeType, quint32 AniInTime, quint32 AniOut
  */
 void QMesBoxWidget::MesBox(const QString &title, const QString &text)
 {
-    if(nullptr == mP_instance){
-        QMutexLocker locker(&m_mutex);
-        if(nullptr == mP_instance){
-            mP_instance = new QMesBoxWidget();
-        }
-    }else{
-        mP_instance->stopAnimation();
-        mP_instance->hide();
+    if(nullptr == instance()){
+        return;
     }
+    mP_instance->prepareDefault();
+    mP_instance->setImage(QString());
+    mP_instance->setBatch(QStringList());
+    mP_instance->titleLabel->setText(title);
+    mP_instance->contentLabel->setText(text);
+    mP_instance->raise();
+    mP_instance->show();
+}
+
+/**
+ * @brief QMesBoxWidget::setIdleTrimTime  设置空闲释放时间     Set the idle trim time
+ * @param IdleTime                        空闲时间（秒），0 为不释放   Idle time in seconds, 0 disables trimming
+ */
+void QMesBoxWidget::setIdleTrimTime(quint32 IdleTime)
+{
+    m_idleTrimTime = IdleTime;
     if(nullptr == mP_instance){
         return;
     }
-    if(mP_instance->checkTime()){
-        mP_instance->initAnimation();
+    // 正在计时或提示框已隐藏时按新时间重新计时，0 时停止
+    if(mP_instance->idleTimer->isActive() || !mP_instance->isVisible()){
+        mP_instance->startIdleTimer();
+    }
+}
+
+/**
+ * @brief QMesBoxWidget::trimCount        空闲释放次数         Number of idle trims
+ */
+quint32 QMesBoxWidget::trimCount()
+{
+    return m_trimCount;
+}
+
+/**
+ * @brief QMesBoxWidget::rebuildCount     释放后重建次数       Number of rebuilds after a trim
+ */
+quint32 QMesBoxWidget::rebuildCount()
+{
+    return m_rebuildCount;
+}
+
+/**
+ * @brief QMesBoxWidget::registerProfile  注册通知配置，同名配置会被覆盖     Registers a notification profile, replacing one with the same id
+ * @param profileId                       配置名称                        Profile id
+ * @param profile                         主题、动画时间、保持时间、动画曲线   Theme, animation times, hold time and easing curve
+ */
+void QMesBoxWidget::registerProfile(const QString &profileId, const MesBoxProfile &profile)
+{
+    m_profiles.insert(profileId,profile);
+    if(mP_instance && !mP_instance->m_trimmed){
+        mP_instance->dropProfileAnimation(profileId);
+        mP_instance->buildProfileAnimation(profileId,profile);   // 注册时预构建，调用时只需查表
     }
-    mP_instance->styleSheet(mP_instance->m_theme,mP_instance);
+}
+
+/**
+ * @brief QMesBoxWidget::MesBox         配置静态调用方法，按配置名查表，不重新初始化动画   Profile static invocation, a table lookup without re-initialization
+ * @param profileId                     配置名称            Profile id
+ * @param title                         标题名称            Title name
+ * @param text                          消息文本            Message text
+ */
+void QMesBoxWidget::MesBox(const QString &profileId, const QString &title, const QString &text)
+{
+    const MesBoxProfile *profile = findProfile(profileId);
+    if(nullptr == profile){
+        return;
+    }
+    MesBox(profileId,title,text,profile->image);
+}
+
+/**
+ * @brief QMesBoxWidget::MesBox         带图片的配置静态调用方法     Profile static invocation with an image
+ * @param profileId                     配置名称            Profile id
+ * @param title                         标题名称            Title name
+ * @param text                          消息文本            Message text
+ * @param image                         图片路径            Image path
+ */
+void QMesBoxWidget::MesBox(const QString &profileId, const QString &title, const QString &text, const QString &image)
+{
+    const MesBoxProfile *profile = findProfile(profileId);
+    if(nullptr == profile || nullptr == instance()){
+        return;
+    }
+    mP_instance->useProfile(profileId,*profile);
+    mP_instance->setImage(image);
+    mP_instance->setBatch(QStringList());
     mP_instance->titleLabel->setText(title);
     mP_instance->contentLabel->setText(text);
     mP_instance->raise();
     mP_instance->show();
 }
 
+/**
+ * @brief QMesBoxWidget::setImageCacheSize  设置已解码图片缓存上限     Set the decoded image cache limit
+ * @param CacheSize                         缓存上限（KB）          Cache limit in KB
+ */
+void QMesBoxWidget::setImageCacheSize(int CacheSize)
+{
+    m_imageCacheSize = qMax(0, CacheSize);
+    if(mP_instance){
+        mP_instance->m_imageCache.setMaxCost(m_imageCacheSize);
+    }
+}
+
+/**
+ * @brief QMesBoxWidget::MesBoxBatch    配置批量调用方法，一次提交全部消息     Profile batch invocation, submits all messages at once
+ * @param profileId                     配置名称            Profile id
+ * @param title                         标题名称            Title name
+ * @param messages                      消息列表            Message list
+ */
+void QMesBoxWidget::MesBoxBatch(const QString &profileId, const QString &title, const QStringList &messages)
+{
+    if(messages.isEmpty()){
+        return;
+    }
+    const MesBoxProfile *profile = findProfile(profileId);
+    if(nullptr == profile || nullptr == instance()){
+        return;
+    }
+    mP_instance->useProfile(profileId,*profile);
+    mP_instance->showBatch(title,messages);
+}
+
+/**
+ * @brief QMesBoxWidget::MesBoxBatch    通用批量调用方法     Generic batch invocation
+ * @param title                         标题名称            Title name
+ * @param messages                      消息列表            Message list
+ */
+void QMesBoxWidget::MesBoxBatch(const QString &title, const QStringList &messages)
+{
+    if(messages.isEmpty() || nullptr == instance()){
+        return;
+    }
+    mP_instance->prepareDefault();
+    mP_instance->showBatch(title,messages);
+}
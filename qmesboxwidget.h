@@ -5,10 +5,17 @@
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QPushButton>
+#include <QEasingCurve>
+#include <QHash>
+#include <QCache>
+#include <QPixmap>
+#include <QSet>
 
 class QPropertyAnimation;
 class QParallelAnimationGroup;
 class QMutex;
+class QListView;
+class QStringListModel;
 //========class QMesBoxWidget========//
 /**
  * @brief 主题枚举
@@ -23,6 +30,26 @@ enum Theme{
     LightTheme,                                     //亮色主题
     DarkTheme                                       //暗色主题
 };
+/**
+ * @brief 通知配置
+ * 注册一次后按名称调用。动画在注册时（内置配置在实例创建时）构建，调用时只需查表；
+ * 主题共用一份已解析的样式表，切换时只修改 theme 属性并重新 polish 受主题影响的控件
+ * 内置 "info"、"warn"、"error" 三种配置
+ *
+ * @brief Notification profile
+ * Registered once and invoked by name. Animations are built at registration (built-in profiles when the
+ * instance is created), so a call only looks them up; themes share one parsed style sheet, switching only
+ * changes the theme property and re-polishes the themed widgets
+ * "info", "warn" and "error" are built in
+ */
+struct MesBoxProfile{
+    Theme theme = ClassicTheme;                     //主题
+    quint32 aniInTime = 1;                          //动画进入时间
+    quint32 aniOutTime = 1;                         //动画退出时间
+    quint32 keepTime = 3;                           //窗口保持时间
+    QEasingCurve easing = QEasingCurve::Linear;     //动画曲线
+    QString image;                                  //图标路径 为空不显示
+};
 /**
  * @class QMesBoxWidget
  * @brief 自定义右下角消息提示框  Customize the message prompt box in the lower right corner
@@ -81,54 +108,142 @@ public:
     static void setMesBox(Theme themeType,quint32 AniInTime,quint32 AniOutTime,quint32 KeepTime);//设置主题 加载、退出、保持时间
     static void MesBox(const QString& title,const QString& text);               //通用静态方法
 
+    /**
+     * @brief registerProfile   注册通知配置，同名覆盖
+     * @brief MesBox            按配置名调用，查表使用预构建的动画；主题不同时切换 theme 属性并重新 polish 主题控件
+     * @param profileId         配置名称
+     */
+    static void registerProfile(const QString& profileId,const MesBoxProfile& profile);//注册通知配置
+    static void MesBox(const QString& profileId,const QString& title,const QString& text);//配置静态调用方法
+
+    /**
+     * @brief MesBox            带图标/图片的配置调用，图片在线程池中解码缩放，解码完成前显示占位图
+     * @brief setImageCacheSize 设置已解码图片缓存上限（KB），按路径与尺寸共享
+     * @param image             图片路径，覆盖配置中的图标
+     */
+    static void MesBox(const QString& profileId,const QString& title,const QString& text,
+                       const QString& image);                                   //带图片静态调用方法
+    static void setImageCacheSize(int CacheSize);                               //设置图片缓存上限
+
+    /**
+     * @brief MesBoxBatch       批量提示，一次提交全部消息，在同一个提示框中以可滚动列表显示，空列表不显示
+     *                          列表只布局、绘制可见行，消息数量不影响显示开销
+     * @param messages          消息列表
+     */
+    static void MesBoxBatch(const QString& profileId,const QString& title,const QStringList& messages);//配置批量调用方法
+    static void MesBoxBatch(const QString& title,const QStringList& messages);  //通用批量调用方法
+
+    /**
+     * @brief setIdleTrimTime   设置空闲释放时间（秒），提示框隐藏（关闭或仅 setMesBox 未显示）后空闲超过该时间即释放控件树、阴影与动画，下次调用时重建，0 为不释放
+     * @brief trimCount         空闲释放次数
+     * @brief rebuildCount      释放后重建次数
+     */
+    static void setIdleTrimTime(quint32 IdleTime);                              //设置空闲释放时间
+    static quint32 trimCount();                                                 //释放次数
+    static quint32 rebuildCount();                                              //重建次数
 
 
 
 //===================private========================//
 private:
     explicit QMesBoxWidget();
+    static QMesBoxWidget* instance();                                           // 获取实例并中断当前提示
     void show();
-    static void styleSheet(Theme themeType,QWidget *widget);                   //主题切换
+    static const char* themeName(Theme themeType);                              //主题名称
+    static const QString& themeStyleSheet();                                    //合并主题样式表
+    void applyTheme(Theme themeType);                                           //主题切换
     void closeEvent(QCloseEvent *event) override;                              //关闭时间重载
     void animationIn();                                                         // 动画进入
     void animationOut();                                                        // 动画退出
 
     void initUI();                                                              // 初始化UI
-    void initAnimation();                                                       // 初始化动画
+    void initAnimation();                                                       // 初始化动画 预构建默认与配置动画
+    void buildAnimation(quint32 AniInTime,quint32 AniOutTime,const QEasingCurve& easing,
+                        QParallelAnimationGroup*& groupIn,QParallelAnimationGroup*& groupOut);// 构建动画组
+    void useAnimation(QParallelAnimationGroup* groupIn,QParallelAnimationGroup* groupOut,quint32 KeepTime);// 设置当前动画
+    void useDefaultAnimation();                                                 // 使用默认时间动画
+    void buildProfileAnimation(const QString& profileId,const MesBoxProfile& profile);// 预构建配置动画
+    void useProfile(const QString& profileId,const MesBoxProfile& profile);     // 使用通知配置
+    void prepareDefault();                                                      // 使用默认主题与动画
+    static const MesBoxProfile* findProfile(const QString& profileId);          // 查找通知配置
+    void dropProfileAnimation(const QString& profileId);                        // 释放配置动画
     void initTimer();                                                           // 初始化定时器
+    void startIdleTimer();                                                      // 开始空闲计时
+    void releaseResources();                                                    // 空闲释放资源
+    void rebuildResources();                                                    // 重建已释放资源
+
+    void setImage(const QString& image);                                        // 设置图标 异步加载
+    QPixmap placeholder();                                                      // 图标占位图
+    void setBatch(const QStringList& messages);                                 // 设置批量消息 为空时显示单条内容
+    void showBatch(const QString& title,const QStringList& messages);           // 显示批量提示
 
     void stopAnimation();                                                       // 中断动画与定时器
-    bool checkTime();                                                           // 检测时间
 private:
+    /**
+     * @brief 配置对应的预构建动画组
+     */
+    struct ProfileAnimation{
+        QParallelAnimationGroup* groupIn = nullptr;                             // 进入动画组
+        QParallelAnimationGroup* groupOut = nullptr;                            // 退出动画组
+    };
+    /**
+     * @brief 按时间就地调整的线性动画组
+     */
+    struct TimedAnimation : ProfileAnimation{
+        quint32 aniInTime = 0;                                                  // 当前进入时间
+        quint32 aniOutTime = 0;                                                 // 当前退出时间
+    };
+    void timeAnimation(TimedAnimation& plan,quint32 AniInTime,quint32 AniOutTime);// 调整时间动画
+    void retimeGroup(QParallelAnimationGroup* group,quint32 duration);          // 设置动画组时长
+
     AnimationMode mode;                                                         // 动画类型
-    QParallelAnimationGroup* m_aniGroupIn = nullptr;                            // 进入动画组
-    QParallelAnimationGroup* m_aniGroupOut = nullptr;                           // 退出动画组
-    QPropertyAnimation* m_opacityIn = nullptr,* m_positionIn = nullptr,
-                     * m_opacityOut = nullptr,* m_positionOut = nullptr;         // 透明度动画 位置动画
+    QParallelAnimationGroup* m_curGroupIn = nullptr;                            // 当前进入动画组
+    QParallelAnimationGroup* m_curGroupOut = nullptr;                           // 当前退出动画组
+    quint32 m_curKeepTime = 3;                                                  // 当前保持时间
+    QHash<QString,ProfileAnimation> m_profileAnimations;                        // 配置动画缓存
+    TimedAnimation m_defaultAnimation;                                          // setMesBox 时间动画
+    TimedAnimation m_singleAnimation;                                           // 主题单次调用时间动画
+    QList<QWidget*> m_themedWidgets;                                            // 受主题影响的控件
+    int m_appliedTheme = -1;                                                    // 已应用主题 -1 为未应用
     QTimer* hideTimer = nullptr;                                                 // 定时器
+    QTimer* idleTimer = nullptr;                                                 // 空闲释放定时器
+    bool m_trimmed = false;                                                      // 资源是否已释放
     Theme m_theme = ClassicTheme;                                                // 默认主题
 
-    QVBoxLayout *mainLayout;
-    QFrame *frame;
-    QVBoxLayout *frameLayout;
-    QWidget *titleArea;
-    QHBoxLayout *titleLayout;
-    QLabel *titleLabel;
-    QLabel *countLabel;
-    QPushButton *btnClose;
-    QLabel *contentLabel;
+    QVBoxLayout *mainLayout = nullptr;
+    QFrame *frame = nullptr;
+    QVBoxLayout *frameLayout = nullptr;
+    QWidget *titleArea = nullptr;
+    QHBoxLayout *titleLayout = nullptr;
+    QLabel *titleLabel = nullptr;
+    QLabel *countLabel = nullptr;
+    QPushButton *btnClose = nullptr;
+    QWidget *contentArea = nullptr;
+    QHBoxLayout *contentLayout = nullptr;
+    QLabel *iconLabel = nullptr;
+    QLabel *contentLabel = nullptr;
+    QListView *batchList = nullptr;
+    QStringListModel *batchModel = nullptr;
+
+    int m_iconSide = 48;                                                        // 图标边长
+    QString m_imageKey;                                                         // 当前图标缓存键
+    QPixmap m_placeholder;                                                      // 占位图
+    QCache<QString,QPixmap> m_imageCache;                                       // 已解码图片缓存 开销单位KB
+    QSet<QString> m_imageLoading;                                               // 正在解码的缓存键
 
     quint32 hideCount;                                                          // 倒计时
     quint32 m_AnimationInTime = 1;                                              // 动画加载时间
     quint32 m_AnimationOutTime = 1;                                             // 动画退出时间
     quint32 m_AnimationDispalyTime = 3;                                         // 窗口显示时间
-    quint32 m_temporaryAnimaIn = 1;
-    quint32 m_temporaryAnimaOut = 1;
-    quint32 m_temporaryAnimaDis = 3;
     QString m_content;                                                          // 文本
 
     static QMesBoxWidget* mP_instance;                                          //静态实例
     static QMutex m_mutex;                                                      //锁
+    static QHash<QString,MesBoxProfile> m_profiles;                             //通知配置表
+    static int m_imageCacheSize;                                                //图片缓存上限
+    static quint32 m_idleTrimTime;                                              //空闲释放时间
+    static quint32 m_trimCount;                                                 //释放次数
+    static quint32 m_rebuildCount;                                              //重建次数
 };
 
 #endif // QMESBOXWIDGET_H
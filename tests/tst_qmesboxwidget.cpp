@@ -0,0 +1,258 @@
+#include "qmesboxwidget.h"
+#include <QtTest>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QParallelAnimationGroup>
+#include <QTemporaryDir>
+#include <QImage>
+#include <QLabel>
+#include <QListView>
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+/**
+ * @brief residentKB
+ * 读取当前进程常驻内存（KB），非 Linux 返回 -1
+ * Reads the resident set size of the process in KB, returns -1 outside Linux
+ */
+static qint64 residentKB(){
+#ifdef Q_OS_LINUX
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if(!statm.open(QIODevice::ReadOnly)){
+        return -1;
+    }
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if(fields.size() < 2){
+        return -1;
+    }
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE) / 1024;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief toast
+ * 查找提示框实例
+ * Finds the message box instance
+ */
+static QMesBoxWidget* toast(){
+    const QWidgetList widgets = QApplication::topLevelWidgets();
+    for(QWidget* widget : widgets){
+        if(QMesBoxWidget* box = qobject_cast<QMesBoxWidget*>(widget)){
+            return box;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief iconColor
+ * 提示框图标中心像素颜色，无图标时返回无效颜色
+ * Center pixel color of the message box icon, invalid when no icon is set
+ */
+static QColor iconColor(){
+    QLabel* icon = toast() ? toast()->findChild<QLabel*>(QStringLiteral("iconLabel")) : nullptr;
+    if(!icon){
+        return QColor();
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
+    const QPixmap pixmap = icon->pixmap();
+#else
+    const QPixmap pixmap = icon->pixmap() ? *icon->pixmap() : QPixmap();
+#endif
+    if(pixmap.isNull()){
+        return QColor();
+    }
+    const QImage image = pixmap.toImage();
+    return image.pixelColor(image.width() / 2, image.height() / 2);
+}
+
+//========class TestQMesBoxWidget========//
+class TestQMesBoxWidget : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void idleTrim();                                                            // 空闲释放 常驻内存与首次提示耗时
+    void profileAlternation();                                                  // 配置交替调用耗时
+    void imageCache();                                                          // 图片冷、热缓存 GUI 线程耗时
+    void emptyBatch();                                                          // 空批量不显示
+    void batchScaling_data();
+    void batchScaling();                                                        // 批量提交与绘制耗时随数量变化
+};
+
+void TestQMesBoxWidget::initTestCase()
+{
+    // 无动画、零保持时间，提示框约 1s 后自动关闭
+    QMesBoxWidget::registerProfile(QStringLiteral("quick"),{ClassicTheme,0,0,0});
+}
+
+void TestQMesBoxWidget::idleTrim()
+{
+    QMesBoxWidget::setIdleTrimTime(1);
+    const quint32 trims = QMesBoxWidget::trimCount();
+    const quint32 rebuilds = QMesBoxWidget::rebuildCount();
+
+    QMesBoxWidget::MesBox(QStringLiteral("quick"),QStringLiteral("trim"),QStringLiteral("before trim"));
+    QVERIFY(toast());
+    QTRY_VERIFY_WITH_TIMEOUT(!toast()->isVisible(),5000);
+    const qint64 before = residentKB();
+    QTRY_COMPARE_WITH_TIMEOUT(QMesBoxWidget::trimCount(),trims + 1,5000);
+    const qint64 after = residentKB();
+
+    QElapsedTimer timer;
+    timer.start();
+    QMesBoxWidget::MesBox(QStringLiteral("quick"),QStringLiteral("trim"),QStringLiteral("first toast after trim"));
+    const double latency = timer.nsecsElapsed() / 1e6;
+    QCOMPARE(QMesBoxWidget::rebuildCount(),rebuilds + 1);
+    QCOMPARE(QMesBoxWidget::trimCount(),trims + 1);
+    // 重建后的控件树完整可用
+    QVERIFY(toast()->isVisible());
+    QLabel* title = toast()->findChild<QLabel*>(QStringLiteral("titleLabel"));
+    QLabel* content = toast()->findChild<QLabel*>(QStringLiteral("contentLabel"));
+    QLabel* count = toast()->findChild<QLabel*>(QStringLiteral("countLabel"));
+    QVERIFY(title);
+    QVERIFY(content);
+    QVERIFY(count);
+    QCOMPARE(title->text(),QStringLiteral("trim"));
+    QCOMPARE(content->text(),QStringLiteral("first toast after trim"));
+    QVERIFY(title->isVisible());
+    QVERIFY(content->isVisible());
+
+    qInfo("RSS before trim: %lld KB, after trim: %lld KB, reclaimed: %lld KB",before,after,before - after);
+    qInfo("first toast after trim: %.3f ms",latency);
+
+    QTRY_VERIFY_WITH_TIMEOUT(!toast()->isVisible(),5000);
+
+    // 仅调用 setMesBox 不显示，同样空闲释放
+    const quint32 hiddenTrims = QMesBoxWidget::trimCount();
+    QMesBoxWidget::setMesBox(ClassicTheme,1,1,3);
+    QVERIFY(!toast()->isVisible());
+    QTRY_COMPARE_WITH_TIMEOUT(QMesBoxWidget::trimCount(),hiddenTrims + 1,5000);
+    QMesBoxWidget::setIdleTrimTime(0);
+}
+
+void TestQMesBoxWidget::profileAlternation()
+{
+    const QStringList profiles{QStringLiteral("info"),QStringLiteral("warn"),QStringLiteral("error")};
+    const int rounds = 300;
+    QMesBoxWidget::MesBox(profiles.first(),QStringLiteral("warm up"),QStringLiteral("warm up"));
+    QMesBoxWidget::MesBox(QStringLiteral("warm up"),QStringLiteral("warm up"));
+    QMesBoxWidget::MesBox(DarkTheme,QStringLiteral("warm up"),QStringLiteral("warm up"),2,2,4);
+    QVERIFY(toast());
+    const int groups = toast()->findChildren<QParallelAnimationGroup*>().size();
+
+    QElapsedTimer timer;
+    timer.start();
+    for(int i = 0; i < rounds; ++i){
+        QMesBoxWidget::MesBox(profiles.at(i % profiles.size()),QStringLiteral("alternate"),QString::number(i));
+    }
+    const double profileCost = timer.nsecsElapsed() / 1e6 / rounds;
+
+    // 主题调用与通用调用交替
+    timer.restart();
+    for(int i = 0; i < rounds; ++i){
+        if(i % 2){
+            // 时间每次不同，动画组就地调整时长而不新增
+            QMesBoxWidget::MesBox(DarkTheme,QStringLiteral("alternate"),QString::number(i),1 + i % 5,1 + i % 3,4);
+        }else{
+            QMesBoxWidget::MesBox(QStringLiteral("alternate"),QString::number(i));
+        }
+    }
+    const double mixedCost = timer.nsecsElapsed() / 1e6 / rounds;
+
+    // 交替调用及不同时间组合都不再构建新的动画组
+    QCOMPARE(toast()->findChildren<QParallelAnimationGroup*>().size(),groups);
+    qInfo("alternating info/warn/error: %.3f ms per call",profileCost);
+    qInfo("alternating MesBox(Theme,...)/MesBox(title,text): %.3f ms per call",mixedCost);
+    toast()->close();
+}
+
+void TestQMesBoxWidget::imageCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    // 路径带 %20，确认缓存键不被 arg 替换
+    const QString path = dir.filePath(QStringLiteral("icon%201.png"));
+    QImage source(1024,1024,QImage::Format_ARGB32);
+    source.fill(Qt::red);
+    QVERIFY(source.save(path));
+
+    // 冷缓存：清空缓存后首次调用，显示占位图，解码完成后显示图片
+    QMesBoxWidget::setImageCacheSize(0);
+    QMesBoxWidget::setImageCacheSize(4096);
+    QElapsedTimer timer;
+    timer.start();
+    QMesBoxWidget::MesBox(QStringLiteral("info"),QStringLiteral("cold"),QStringLiteral("cold cache"),path);
+    const double coldCall = timer.nsecsElapsed() / 1e6;
+    QVERIFY(iconColor() != QColor(Qt::red));
+    QTRY_COMPARE_WITH_TIMEOUT(iconColor(),QColor(Qt::red),5000);
+    const double coldReady = timer.nsecsElapsed() / 1e6;
+
+    // 热缓存：调用返回时图片已设置
+    timer.restart();
+    QMesBoxWidget::MesBox(QStringLiteral("info"),QStringLiteral("warm"),QStringLiteral("warm cache"),path);
+    const double warmCall = timer.nsecsElapsed() / 1e6;
+    QCOMPARE(iconColor(),QColor(Qt::red));
+
+    qInfo("cold cache: %.3f ms on GUI thread, icon ready after %.3f ms",coldCall,coldReady);
+    qInfo("warm cache: %.3f ms on GUI thread, icon ready immediately",warmCall);
+    toast()->close();
+}
+
+void TestQMesBoxWidget::emptyBatch()
+{
+    QMesBoxWidget::MesBox(QStringLiteral("info"),QStringLiteral("single"),QStringLiteral("single message"));
+    QVERIFY(toast());
+    toast()->close();
+    QMesBoxWidget::MesBoxBatch(QStringLiteral("info"),QStringLiteral("empty"),QStringList());
+    QVERIFY(!toast()->isVisible());
+}
+
+void TestQMesBoxWidget::batchScaling_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("10") << 10;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+void TestQMesBoxWidget::batchScaling()
+{
+    QFETCH(int, count);
+    QStringList messages;
+    messages.reserve(count);
+    for(int i = 0; i < count; ++i){
+        messages << QStringLiteral("job %1: done").arg(i);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QMesBoxWidget::MesBoxBatch(QStringLiteral("info"),QStringLiteral("batch %1"),messages);
+    const double submit = timer.nsecsElapsed() / 1e6;
+
+    QVERIFY(toast());
+    QListView* list = toast()->findChild<QListView*>(QStringLiteral("batchList"));
+    QVERIFY(list);
+    QVERIFY(list->isVisible());
+    QCOMPARE(list->model()->rowCount(),count);
+    // 标题中的 %1 原样保留
+    QLabel* title = toast()->findChild<QLabel*>(QStringLiteral("titleLabel"));
+    QCOMPARE(title->text(),QStringLiteral("batch %1 (") + QString::number(count) + QLatin1Char(')'));
+
+    // 布局 + 绘制可见行
+    timer.restart();
+    list->doItemsLayout();
+    const QPixmap frame = list->viewport()->grab();
+    const double paint = timer.nsecsElapsed() / 1e6;
+    QVERIFY(!frame.isNull());
+
+    qInfo("batch of %d: submit %.3f ms, layout + paint %.3f ms",count,submit,paint);
+    toast()->close();
+}
+
+QTEST_MAIN(TestQMesBoxWidget)
+#include "tst_qmesboxwidget.moc"